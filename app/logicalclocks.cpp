@@ -5,14 +5,14 @@
 
 namespace {
 
-// Check if vectorClock1 happened before, after og concurrently with vectorClock2. The compare function is heavily inspired by the Voldemort Project: https://github.com/voldemort/voldemort
-VectorClock::LocalOccured compare(VectorClock* vectorClock1, VectorClock* vectorClock2)
+// Check if vector1 happened before, after og concurrently with vector2. The compare function is heavily inspired by the Voldemort Project: https://github.com/voldemort/voldemort
+VectorClock::LocalOccured compare(const QMap<qint32, qint32>& vector1, const QMap<qint32, qint32>& vector2)
 {
     auto vc1VersionGreater = false;
     auto vc2VersionGreater = false;
 
-    const auto vc1Keys = vectorClock1->ids();
-    const auto vc2Keys = vectorClock2->ids();
+    const auto vc1Keys = vector1.keys();
+    const auto vc2Keys = vector2.keys();
     const auto commonKeys = vc1Keys.toSet().intersect(vc2Keys.toSet());
 
     if (vc1Keys.size() > commonKeys.size())
@@ -25,8 +25,8 @@ VectorClock::LocalOccured compare(VectorClock* vectorClock1, VectorClock* vector
         if (vc1VersionGreater && vc2VersionGreater)
             break;
 
-        const auto vc1Version = vectorClock1->count().find(key).value();
-        const auto vc2Version = vectorClock2->count().find(key).value();
+        const auto vc1Version = vector1.value(key);
+        const auto vc2Version = vector2.value(key);
 
         if (vc1Version > vc2Version)
             vc1VersionGreater = true;
@@ -135,8 +135,7 @@ QMap<qint32, qint32> VectorClock::count() const
 
 VectorClock::LocalOccured VectorClock::receive(QMap<qint32, qint32> vector)
 {
-    VectorClock vc(0, vector);
-    const auto occured = compare(this, &vc);
+    const auto occured = compare(count(), vector);
 
     // Update local vector's common clocks
     updateLocalVectorToGreatestClocksOfLocalAndRemote(vector);
@@ -161,8 +160,12 @@ void VectorClock::updateLocalVectorToGreatestClocksOfLocalAndRemote(const QMap<q
 VersionedData::VersionedData(const QVariant &data, qint32 localClockId, const QMap<qint32, qint32> &vectorclocks, std::function<QVariant (const QVariant &, const QVariant &)> conflictResolution)
     : m_data(data),
       m_vectorClock(localClockId, vectorclocks),
-      m_conflictResolution(conflictResolution)
+      m_conflictResolution(conflictResolution),
+      m_pendingVectorClock(localClockId),
+      m_flushTimer(this)
 {
+    m_flushTimer.setSingleShot(true);
+    connect(&m_flushTimer, &QTimer::timeout, this, &VersionedData::flush);
 }
 
 QVariant VersionedData::data() const
@@ -172,15 +175,116 @@ QVariant VersionedData::data() const
 
 void VersionedData::sendData()
 {
+    // Pending remote updates must be part of the clock that is sent
+    flush();
+    Q_ASSERT(m_pendingCount == 0);
+    m_modifiedSinceSend = false;
     m_vectorClock.send();
 }
 
+void VersionedData::setCoalescing(bool enabled, qint32 flushInterval, qint32 flushThreshold)
+{
+    if (!enabled)
+        flush();
+
+    m_coalescing = enabled;
+    m_flushTimer.setInterval(flushInterval);
+    m_flushThreshold = flushThreshold;
+}
+
+bool VersionedData::isCoalescing() const
+{
+    return m_coalescing;
+}
+
+void VersionedData::flush()
+{
+    m_flushTimer.stop();
+    if (m_pendingCount == 0)
+        return;
+
+    if (m_hasPendingData)
+        m_data = m_pendingData;
+
+    // The pending vector clock replaces the local vector clock, so the local vector clock must not change while updates
+    // are pending. Everything that changes it flushes first.
+    m_vectorClock = VectorClock(m_vectorClock.localId(), m_pendingVectorClock.count());
+    m_pendingCount = 0;
+    m_hasPendingData = false;
+    m_pendingData.clear();
+}
+
+void VersionedData::postDataReceived(const QMap<qint32, qint32> &vector, const QVariant &data)
+{
+    QMutexLocker locker(&m_postedMutex);
+    m_posted.append(qMakePair(vector, data));
+
+    // A queued call is already waiting unless this is the first posted update
+    if (m_posted.size() == 1)
+        QMetaObject::invokeMethod(this, &VersionedData::receivePostedData, Qt::QueuedConnection);
+}
+
+void VersionedData::receivePostedData()
+{
+    QList<QPair<QMap<qint32, qint32>, QVariant>> posted;
+    {
+        QMutexLocker locker(&m_postedMutex);
+        posted.swap(m_posted);
+    }
+
+    for (const auto& update : posted)
+        onDataReceived(update.first, update.second);
+}
+
 void VersionedData::onDataModified()
 {
+    // Pending remote updates happened before this modification
+    if (m_coalescing)
+        flush();
+
+    // Modifications not yet sent are indistinguishable to remotes, so one tick is enough
+    if (m_coalescing && m_modifiedSinceSend)
+        return;
+
+    Q_ASSERT(m_pendingCount == 0);
+    m_modifiedSinceSend = true;
     m_vectorClock.event();
 }
 
 void VersionedData::onDataReceived(const QMap<qint32, qint32> &vector, const QVariant &data) {
+    if (!m_coalescing) {
+        receiveData(vector, data);
+        return;
+    }
+
+    // The pending vector clock is the local vector clock after receiving all pending updates one by one
+    if (m_pendingCount == 0)
+        m_pendingVectorClock = VectorClock(m_vectorClock.localId(), m_vectorClock.count());
+
+    const auto occured = m_pendingVectorClock.receive(vector);
+    if (occured == VectorClock::LocalOccured::AfterRemote) {
+        // Do nothing as pending or local data is newer than remote data
+    } else if (occured == VectorClock::LocalOccured::BeforeRemote) {
+        // Replace pending data with newer remote data
+        m_pendingData = data;
+        m_hasPendingData = true;
+    } else if (occured == VectorClock::LocalOccured::ConcurrentlyWithRemote) {
+        // Conflicts are resolved against local data, so pending data is applied first
+        ++m_pendingCount;
+        flush();
+        m_data = m_conflictResolution(m_data, data);
+        return;
+    }
+
+    if (++m_pendingCount >= m_flushThreshold && m_flushThreshold > 0)
+        flush();
+    else if (!m_flushTimer.isActive())
+        m_flushTimer.start();
+}
+
+void VersionedData::receiveData(const QMap<qint32, qint32> &vector, const QVariant &data)
+{
+    Q_ASSERT(m_pendingCount == 0);
     const auto occured = m_vectorClock.receive(vector);
     if (occured == VectorClock::LocalOccured::AfterRemote) {
         // Do nothing as local data is newer than remote data
@@ -4,6 +4,8 @@
 #include <QObject>
 #include <QMap>
 #include <QVariant>
+#include <QTimer>
+#include <QMutex>
 
 // A Lamport timestamp logical clock: https://en.wikipedia.org/wiki/Lamport_timestamps
 class Clock
@@ -53,14 +55,42 @@ public:
     QVariant data() const;
     void sendData();
 
+    // Coalescing mode: local modifications between sendData() calls collapse into one clock tick. Received remote updates
+    // are kept as one pending update holding the newest data, and a concurrent update applies it before conflict resolution.
+    // The pending update is applied when flushThreshold updates have been received (0 = no threshold), when flushInterval
+    // milliseconds have passed since the first one (0 = on the next pass of the event loop), on a local modification, on
+    // sendData() or on flush(). The interval needs a running event loop in the object's thread.
+    void setCoalescing(bool enabled, qint32 flushInterval = 0, qint32 flushThreshold = 0);
+    bool isCoalescing() const;
+    void flush();
+
+    // Thread safe alternative to a queued onDataReceived() connection. Updates posted before the object's thread handles
+    // them are received together from one queued call instead of one queued call each.
+    void postDataReceived(const QMap<qint32, qint32>& vector, const QVariant& data);
+
 public slots:
     void onDataModified();
     void onDataReceived(const QMap<qint32, qint32>& vector, const QVariant& data);
 
 private:
+    void receiveData(const QMap<qint32, qint32>& vector, const QVariant& data);
+    void receivePostedData();
+
     QVariant m_data;
     VectorClock m_vectorClock;
     std::function<QVariant(const QVariant& localData, const QVariant& remoteData)> m_conflictResolution;
+
+    bool m_coalescing = false;
+    bool m_modifiedSinceSend = false;
+    qint32 m_flushThreshold = 0;
+    qint32 m_pendingCount = 0;
+    bool m_hasPendingData = false;
+    QVariant m_pendingData;
+    VectorClock m_pendingVectorClock;
+    QTimer m_flushTimer;
+
+    QMutex m_postedMutex;
+    QList<QPair<QMap<qint32, qint32>, QVariant>> m_posted;
 };
 
 #endif // LOGICALCLOCKS_H
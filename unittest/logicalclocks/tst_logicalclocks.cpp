@@ -31,6 +31,16 @@ private slots:
     void VersionedData_requireThat_LocalDataIsUpdatedWithRemoteDataWhenLocalVersionIsLessThanRemoteVersionOnReceive();
     void VersionedData_requireThat_LocalDataIsUpdatedWithRemoteDataWhenLocalVersionIsEqualToRemoteVersionOnReceive();
     void VersionedData_requireThat_LocalDataIsUpdatedAccordingToConflictResolutionStrategyWhenLocalAndRemoteChangesHappenedConcurrently();
+    void VersionedData_requireThat_LocalModificationsBetweenSendsCollapseIntoOneTickWhenCoalescing();
+    void VersionedData_requireThat_ReceivedDataIsNotAppliedBeforeFlushWhenCoalescing();
+    void VersionedData_requireThat_NewestReceivedDataIsAppliedOnFlushWhenCoalescing();
+    void VersionedData_requireThat_ReceivedDataIsFlushedWhenThresholdIsReachedWhenCoalescing();
+    void VersionedData_requireThat_ReceivedDataIsFlushedByEventLoopWhenCoalescing();
+    void VersionedData_requireThat_ReceivedDataIsFlushedBeforeLocalModificationWhenCoalescing();
+    void VersionedData_requireThat_ConflictResolutionGivesSameDataWithAndWithoutCoalescing();
+    void VersionedData_requireThat_PostedDataIsReceivedByEventLoop();
+    void VersionedData_requireThat_ReceivedDataIsFlushedOnSendWhenCoalescing();
+    void VersionedData_requireThat_ReceivedDataIsFlushedWhenCoalescingIsDisabled();
 };
 
 void LogicalClocksTest::Clock_requireThat_ClockCountIsZeroWhenDefaultConstructed()
@@ -400,6 +410,328 @@ void LogicalClocksTest::VersionedData_requireThat_LocalDataIsUpdatedAccordingToC
     QCOMPARE(versionedData.data(), mergedData);
 }
 
+void LogicalClocksTest::VersionedData_requireThat_LocalModificationsBetweenSendsCollapseIntoOneTickWhenCoalescing()
+{
+    const auto localData = QVariant::fromValue(QString("LocalData"));
+
+    QMap<qint32, qint32> localVectorClock;
+    localVectorClock.insert(0, 10);
+    localVectorClock.insert(1, 99);
+
+    const auto remoteData = QVariant::fromValue(QString("RemoteData"));
+
+    // Local clock is 99 + 1 (event) + 1 (send) + 1 (event) = 102 after the modifications, so a remote clock of 101
+    // is older and a remote clock of 102 is applied
+    for (const auto remoteClock : { 101, 102 }) {
+        VersionedData versionedData(localData, 1, localVectorClock, [=](const QVariant& localData, const QVariant& remoteData) -> QVariant {
+            Q_UNUSED(localData)
+            Q_UNUSED(remoteData)
+            return QVariant();
+        });
+        versionedData.setCoalescing(true);
+
+        versionedData.onDataModified();
+        versionedData.onDataModified();
+        versionedData.onDataModified();
+        versionedData.sendData();
+        versionedData.onDataModified();
+        versionedData.onDataModified();
+
+        QMap<qint32, qint32> remoteVectorClock;
+        remoteVectorClock.insert(0, 10);
+        remoteVectorClock.insert(1, remoteClock);
+
+        versionedData.onDataReceived(remoteVectorClock, remoteData);
+        versionedData.flush();
+        QCOMPARE(versionedData.data(), remoteClock == 102 ? remoteData : localData);
+    }
+}
+
+void LogicalClocksTest::VersionedData_requireThat_ReceivedDataIsNotAppliedBeforeFlushWhenCoalescing()
+{
+    const auto localData = QVariant::fromValue(QString("LocalData"));
+
+    QMap<qint32, qint32> localVectorClock;
+    localVectorClock.insert(0, 10);
+    localVectorClock.insert(1, 54);
+
+    VersionedData versionedData(localData, 1, localVectorClock, [=](const QVariant& localData, const QVariant& remoteData) -> QVariant {
+        Q_UNUSED(localData)
+        Q_UNUSED(remoteData)
+        return QVariant();
+    });
+    versionedData.setCoalescing(true, 60000);
+
+    QMap<qint32, qint32> remoteVectorClock;
+    remoteVectorClock.insert(0, 11);
+    remoteVectorClock.insert(1, 99);
+
+    const auto remoteData = QVariant::fromValue(QString("RemoteData"));
+    versionedData.onDataReceived(remoteVectorClock, remoteData);
+    QCOMPARE(versionedData.data(), localData);
+
+    versionedData.flush();
+    QCOMPARE(versionedData.data(), remoteData);
+}
+
+void LogicalClocksTest::VersionedData_requireThat_NewestReceivedDataIsAppliedOnFlushWhenCoalescing()
+{
+    const auto localData = QVariant::fromValue(QString("LocalData"));
+
+    QMap<qint32, qint32> localVectorClock;
+    localVectorClock.insert(0, 10);
+    localVectorClock.insert(1, 54);
+
+    VersionedData versionedData(localData, 1, localVectorClock, [=](const QVariant& localData, const QVariant& remoteData) -> QVariant {
+        Q_UNUSED(localData)
+        Q_UNUSED(remoteData)
+        return QVariant();
+    });
+    versionedData.setCoalescing(true, 60000);
+
+    QMap<qint32, qint32> newestVectorClock;
+    newestVectorClock.insert(0, 13);
+    newestVectorClock.insert(1, 99);
+
+    QMap<qint32, qint32> olderVectorClock;
+    olderVectorClock.insert(0, 11);
+    olderVectorClock.insert(1, 99);
+
+    const auto newestData = QVariant::fromValue(QString("NewestRemoteData"));
+    versionedData.onDataReceived(olderVectorClock, QVariant::fromValue(QString("OlderRemoteData")));
+    versionedData.onDataReceived(newestVectorClock, newestData);
+    versionedData.onDataReceived(olderVectorClock, QVariant::fromValue(QString("OlderRemoteData")));
+    versionedData.flush();
+    QCOMPARE(versionedData.data(), newestData);
+}
+
+void LogicalClocksTest::VersionedData_requireThat_ReceivedDataIsFlushedWhenThresholdIsReachedWhenCoalescing()
+{
+    const auto localData = QVariant::fromValue(QString("LocalData"));
+
+    QMap<qint32, qint32> localVectorClock;
+    localVectorClock.insert(0, 10);
+    localVectorClock.insert(1, 54);
+
+    VersionedData versionedData(localData, 1, localVectorClock, [=](const QVariant& localData, const QVariant& remoteData) -> QVariant {
+        Q_UNUSED(localData)
+        Q_UNUSED(remoteData)
+        return QVariant();
+    });
+    versionedData.setCoalescing(true, 60000, 2);
+
+    QMap<qint32, qint32> remoteVectorClock;
+    remoteVectorClock.insert(0, 11);
+    remoteVectorClock.insert(1, 99);
+
+    const auto remoteData = QVariant::fromValue(QString("RemoteData"));
+    versionedData.onDataReceived(remoteVectorClock, remoteData);
+    QCOMPARE(versionedData.data(), localData);
+
+    remoteVectorClock.insert(0, 12);
+    versionedData.onDataReceived(remoteVectorClock, remoteData);
+    QCOMPARE(versionedData.data(), remoteData);
+}
+
+void LogicalClocksTest::VersionedData_requireThat_ReceivedDataIsFlushedByEventLoopWhenCoalescing()
+{
+    const auto localData = QVariant::fromValue(QString("LocalData"));
+
+    QMap<qint32, qint32> localVectorClock;
+    localVectorClock.insert(0, 10);
+    localVectorClock.insert(1, 54);
+
+    VersionedData versionedData(localData, 1, localVectorClock, [=](const QVariant& localData, const QVariant& remoteData) -> QVariant {
+        Q_UNUSED(localData)
+        Q_UNUSED(remoteData)
+        return QVariant();
+    });
+    versionedData.setCoalescing(true, 10);
+
+    QMap<qint32, qint32> remoteVectorClock;
+    remoteVectorClock.insert(0, 11);
+    remoteVectorClock.insert(1, 99);
+
+    const auto remoteData = QVariant::fromValue(QString("RemoteData"));
+    versionedData.onDataReceived(remoteVectorClock, remoteData);
+    QCOMPARE(versionedData.data(), localData);
+    QTRY_COMPARE(versionedData.data(), remoteData);
+}
+
+void LogicalClocksTest::VersionedData_requireThat_ReceivedDataIsFlushedBeforeLocalModificationWhenCoalescing()
+{
+    const auto localData = QVariant::fromValue(QString("LocalData"));
+
+    QMap<qint32, qint32> localVectorClock;
+    localVectorClock.insert(1, 5);
+
+    VersionedData versionedData(localData, 1, localVectorClock, [=](const QVariant& localData, const QVariant& remoteData) -> QVariant {
+        Q_UNUSED(remoteData)
+        return localData;
+    });
+    versionedData.setCoalescing(true, 60000);
+
+    QMap<qint32, qint32> remoteVectorClock;
+    remoteVectorClock.insert(0, 3);
+    remoteVectorClock.insert(1, 5);
+
+    const auto remoteData = QVariant::fromValue(QString("RemoteData"));
+    versionedData.onDataReceived(remoteVectorClock, remoteData);
+    versionedData.onDataModified();
+    versionedData.flush();
+    QCOMPARE(versionedData.data(), remoteData);
+
+    // Local clock is {0:3, 1:6} after receiving and {0:3, 1:7} after the modification, so a remote clock equal to the
+    // clock before the modification is older and ignored
+    QMap<qint32, qint32> olderVectorClock;
+    olderVectorClock.insert(0, 3);
+    olderVectorClock.insert(1, 6);
+
+    versionedData.onDataReceived(olderVectorClock, QVariant::fromValue(QString("OlderRemoteData")));
+    versionedData.flush();
+    QCOMPARE(versionedData.data(), remoteData);
+}
+
+void LogicalClocksTest::VersionedData_requireThat_ConflictResolutionGivesSameDataWithAndWithoutCoalescing()
+{
+    QMap<qint32, qint32> localVectorClock;
+    localVectorClock.insert(0, 10);
+    localVectorClock.insert(1, 54);
+
+    const auto sum = [](const QVariant& localData, const QVariant& remoteData) -> QVariant {
+        return localData.toInt() + remoteData.toInt();
+    };
+    VersionedData sequentialData(QVariant::fromValue(1), 1, localVectorClock, sum);
+    VersionedData coalescedData(QVariant::fromValue(1), 1, localVectorClock, sum);
+    coalescedData.setCoalescing(true, 60000);
+
+    // Older than local
+    QMap<qint32, qint32> remoteVectorClock1;
+    remoteVectorClock1.insert(0, 9);
+    remoteVectorClock1.insert(1, 54);
+
+    // Concurrent with local and the first update
+    QMap<qint32, qint32> remoteVectorClock2;
+    remoteVectorClock2.insert(0, 8);
+    remoteVectorClock2.insert(1, 60);
+
+    // Concurrent with the second update
+    QMap<qint32, qint32> remoteVectorClock3;
+    remoteVectorClock3.insert(0, 11);
+    remoteVectorClock3.insert(1, 56);
+
+    // Newer than the third update
+    QMap<qint32, qint32> remoteVectorClock4;
+    remoteVectorClock4.insert(0, 12);
+    remoteVectorClock4.insert(1, 61);
+
+    // Older than the fourth update
+    QMap<qint32, qint32> remoteVectorClock5;
+    remoteVectorClock5.insert(0, 11);
+    remoteVectorClock5.insert(1, 62);
+
+    // Concurrent with the fourth update
+    QMap<qint32, qint32> remoteVectorClock6;
+    remoteVectorClock6.insert(0, 13);
+    remoteVectorClock6.insert(1, 60);
+
+    for (auto versionedData : { &sequentialData, &coalescedData }) {
+        versionedData->onDataReceived(remoteVectorClock1, QVariant::fromValue(10));
+        versionedData->onDataReceived(remoteVectorClock2, QVariant::fromValue(100));
+        versionedData->onDataReceived(remoteVectorClock3, QVariant::fromValue(1000));
+        versionedData->onDataReceived(remoteVectorClock4, QVariant::fromValue(10000));
+        versionedData->onDataReceived(remoteVectorClock5, QVariant::fromValue(100000));
+        versionedData->onDataReceived(remoteVectorClock6, QVariant::fromValue(1000000));
+    }
+    coalescedData.flush();
+
+    QCOMPARE(coalescedData.data(), sequentialData.data());
+}
+
+void LogicalClocksTest::VersionedData_requireThat_PostedDataIsReceivedByEventLoop()
+{
+    const auto localData = QVariant::fromValue(QString("LocalData"));
+
+    QMap<qint32, qint32> localVectorClock;
+    localVectorClock.insert(0, 10);
+    localVectorClock.insert(1, 54);
+
+    VersionedData versionedData(localData, 1, localVectorClock, [=](const QVariant& localData, const QVariant& remoteData) -> QVariant {
+        Q_UNUSED(localData)
+        Q_UNUSED(remoteData)
+        return QVariant();
+    });
+
+    QMap<qint32, qint32> olderVectorClock;
+    olderVectorClock.insert(0, 11);
+    olderVectorClock.insert(1, 99);
+
+    QMap<qint32, qint32> newestVectorClock;
+    newestVectorClock.insert(0, 13);
+    newestVectorClock.insert(1, 99);
+
+    const auto newestData = QVariant::fromValue(QString("NewestRemoteData"));
+    versionedData.postDataReceived(olderVectorClock, QVariant::fromValue(QString("OlderRemoteData")));
+    versionedData.postDataReceived(newestVectorClock, newestData);
+    QCOMPARE(versionedData.data(), localData);
+    QTRY_COMPARE(versionedData.data(), newestData);
+}
+
+void LogicalClocksTest::VersionedData_requireThat_ReceivedDataIsFlushedOnSendWhenCoalescing()
+{
+    const auto localData = QVariant::fromValue(QString("LocalData"));
+
+    QMap<qint32, qint32> localVectorClock;
+    localVectorClock.insert(0, 10);
+    localVectorClock.insert(1, 54);
+
+    VersionedData versionedData(localData, 1, localVectorClock, [=](const QVariant& localData, const QVariant& remoteData) -> QVariant {
+        Q_UNUSED(localData)
+        Q_UNUSED(remoteData)
+        return QVariant();
+    });
+    versionedData.setCoalescing(true, 60000);
+
+    QMap<qint32, qint32> remoteVectorClock;
+    remoteVectorClock.insert(0, 11);
+    remoteVectorClock.insert(1, 99);
+
+    const auto remoteData = QVariant::fromValue(QString("RemoteData"));
+    versionedData.onDataReceived(remoteVectorClock, remoteData);
+    QCOMPARE(versionedData.data(), localData);
+
+    versionedData.sendData();
+    QCOMPARE(versionedData.data(), remoteData);
+}
+
+void LogicalClocksTest::VersionedData_requireThat_ReceivedDataIsFlushedWhenCoalescingIsDisabled()
+{
+    const auto localData = QVariant::fromValue(QString("LocalData"));
+
+    QMap<qint32, qint32> localVectorClock;
+    localVectorClock.insert(0, 10);
+    localVectorClock.insert(1, 54);
+
+    VersionedData versionedData(localData, 1, localVectorClock, [=](const QVariant& localData, const QVariant& remoteData) -> QVariant {
+        Q_UNUSED(localData)
+        Q_UNUSED(remoteData)
+        return QVariant();
+    });
+    versionedData.setCoalescing(true, 60000);
+
+    QMap<qint32, qint32> remoteVectorClock;
+    remoteVectorClock.insert(0, 11);
+    remoteVectorClock.insert(1, 99);
+
+    const auto remoteData = QVariant::fromValue(QString("RemoteData"));
+    versionedData.onDataReceived(remoteVectorClock, remoteData);
+    QCOMPARE(versionedData.data(), localData);
+
+    versionedData.setCoalescing(false);
+    QVERIFY(!versionedData.isCoalescing());
+    QCOMPARE(versionedData.data(), remoteData);
+}
+
 QTEST_GUILESS_MAIN(LogicalClocksTest)
 
 #include "tst_logicalclocks.moc"
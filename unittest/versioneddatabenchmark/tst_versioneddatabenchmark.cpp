@@ -0,0 +1,154 @@
+#include <QtTest>
+#include "logicalclocks.h"
+
+// Sends remote updates through a queued signal connection to VersionedData::onDataReceived()
+class Remote : public QObject
+{
+    Q_OBJECT
+signals:
+    void dataSent(const QMap<qint32, qint32>& vector, const QVariant& data);
+};
+
+namespace {
+
+const auto UpdatesPerIteration = qint32(10000);
+const auto LatencySamples = qint32(100);
+
+// Counts conflict resolutions, which must stay zero for updates to be coalesced
+std::unique_ptr<VersionedData> createVersionedData(qint32* conflicts)
+{
+    QMap<qint32, qint32> localVectorClock;
+    localVectorClock.insert(0, 0);
+    localVectorClock.insert(1, 0);
+
+    return std::make_unique<VersionedData>(QVariant::fromValue(qint32(0)), 1, localVectorClock, [=](const QVariant& localData, const QVariant& remoteData) -> QVariant {
+        Q_UNUSED(localData)
+        ++*conflicts;
+        return remoteData;
+    });
+}
+
+// Queue a remote update through a queued signal connection, or through postDataReceived(). The remote has
+// received every earlier update, so its clock for the local id keeps up with the local clock and each update happened
+// after the previous one. A remote clock of 0 for the local id would make every update concurrent and flush it at once.
+void queueDataReceived(Remote* remote, VersionedData* versionedData, qint32 remoteCounter, bool posted)
+{
+    QMap<qint32, qint32> remoteVectorClock;
+    remoteVectorClock.insert(0, remoteCounter);
+    remoteVectorClock.insert(1, remoteCounter);
+    const auto remoteData = QVariant::fromValue(remoteCounter);
+
+    if (posted) {
+        versionedData->postDataReceived(remoteVectorClock, remoteData);
+        return;
+    }
+
+    emit remote->dataSent(remoteVectorClock, remoteData);
+}
+
+void waitForData(VersionedData* versionedData, qint32 remoteCounter)
+{
+    while (versionedData->data().toInt() != remoteCounter)
+        QCoreApplication::processEvents();
+}
+}
+
+class VersionedDataBenchmark : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void VersionedData_throughputOfQueuedReceives_data();
+    void VersionedData_throughputOfQueuedReceives();
+    void VersionedData_latencyOfQueuedReceive_data();
+    void VersionedData_latencyOfQueuedReceive();
+
+private:
+    void addCoalescingRows();
+};
+
+void VersionedDataBenchmark::initTestCase()
+{
+    qRegisterMetaType<QMap<qint32, qint32>>();
+}
+
+void VersionedDataBenchmark::addCoalescingRows()
+{
+    QTest::addColumn<bool>("coalescing");
+    QTest::addColumn<qint32>("flushInterval");
+    QTest::addColumn<qint32>("flushThreshold");
+    QTest::addColumn<bool>("posted");
+
+    QTest::newRow("coalescing off") << false << 0 << 0 << false;
+    QTest::newRow("coalescing on, flush when idle") << true << 0 << 0 << false;
+    QTest::newRow("coalescing on, flush every 1 ms or 64 updates") << true << 1 << 64 << false;
+    QTest::newRow("coalescing off, posted") << false << 0 << 0 << true;
+    QTest::newRow("coalescing on, flush when idle, posted") << true << 0 << 0 << true;
+}
+
+void VersionedDataBenchmark::VersionedData_throughputOfQueuedReceives_data()
+{
+    addCoalescingRows();
+}
+
+void VersionedDataBenchmark::VersionedData_throughputOfQueuedReceives()
+{
+    QFETCH(bool, coalescing);
+    QFETCH(qint32, flushInterval);
+    QFETCH(qint32, flushThreshold);
+    QFETCH(bool, posted);
+
+    auto conflicts = qint32(0);
+    auto versionedData = createVersionedData(&conflicts);
+    versionedData->setCoalescing(coalescing, flushInterval, flushThreshold);
+
+    Remote remote;
+    connect(&remote, &Remote::dataSent, versionedData.get(), &VersionedData::onDataReceived, Qt::QueuedConnection);
+
+    auto remoteCounter = qint32(0);
+    QBENCHMARK {
+        for (auto i = 0; i < UpdatesPerIteration; ++i)
+            queueDataReceived(&remote, versionedData.get(), ++remoteCounter, posted);
+
+        waitForData(versionedData.get(), remoteCounter);
+    }
+
+    QCOMPARE(conflicts, 0);
+}
+
+void VersionedDataBenchmark::VersionedData_latencyOfQueuedReceive_data()
+{
+    addCoalescingRows();
+}
+
+void VersionedDataBenchmark::VersionedData_latencyOfQueuedReceive()
+{
+    QFETCH(bool, coalescing);
+    QFETCH(qint32, flushInterval);
+    QFETCH(qint32, flushThreshold);
+    QFETCH(bool, posted);
+
+    auto conflicts = qint32(0);
+    auto versionedData = createVersionedData(&conflicts);
+    versionedData->setCoalescing(coalescing, flushInterval, flushThreshold);
+
+    Remote remote;
+    connect(&remote, &Remote::dataSent, versionedData.get(), &VersionedData::onDataReceived, Qt::QueuedConnection);
+
+    // Time from posting a single update until it is visible in data()
+    QElapsedTimer timer;
+    auto elapsed = qint64(0);
+    for (auto remoteCounter = 1; remoteCounter <= LatencySamples; ++remoteCounter) {
+        timer.start();
+        queueDataReceived(&remote, versionedData.get(), remoteCounter, posted);
+        waitForData(versionedData.get(), remoteCounter);
+        elapsed += timer.nsecsElapsed();
+    }
+
+    QCOMPARE(conflicts, 0);
+    QTest::setBenchmarkResult(qreal(elapsed) / LatencySamples / 1000000, QTest::WalltimeMilliseconds);
+}
+
+QTEST_GUILESS_MAIN(VersionedDataBenchmark)
+
+#include "tst_versioneddatabenchmark.moc"
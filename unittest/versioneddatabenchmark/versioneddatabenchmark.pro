@@ -0,0 +1,15 @@
+QT += testlib
+
+CONFIG += qt console warn_on depend_includepath c++17
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+INCLUDEPATH += $$PWD/../../app
+
+SOURCES += \
+    ../../app/logicalclocks.cpp \
+    tst_versioneddatabenchmark.cpp
+
+HEADERS += \
+    ../../app/logicalclocks.h